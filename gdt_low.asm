@@ -16,3 +16,24 @@ _gdt_flush:
 	jmp 0x08:flush2	; 0x08 is the offset to our code segment: FAR JUMP!
 flush2:
 	ret		; Returns back to the C code!
+
+; Load the GDT of a CPU (see 'GDT::init_cpu()'): reload the segment
+; registers, point GS at the per-CPU data, and load the task register.
+; This is declared in C as 'extern void gdt_load_cpu(struct gdt_ptr * _gp);'
+global _gdt_load_cpu
+
+_gdt_load_cpu:
+	mov eax, [esp+4]	; pointer to the gdt_ptr of this CPU
+	lgdt [eax]
+	mov ax, 0x10		; kernel data segment
+	mov ds, ax
+	mov es, ax
+	mov fs, ax
+	mov ss, ax
+	jmp 0x08:flush3		; reload CS
+flush3:
+	mov ax, 0x20		; per-CPU data segment
+	mov gs, ax
+	mov ax, 0x18		; TSS
+	ltr ax
+	ret
@@ -0,0 +1,117 @@
+; This file contains the entry stubs for "hot" vectors, i.e. the vectors that
+; fire often enough that the generic path through 'isr_common_stub' and
+; 'irq_common_stub' shows up in profiles:
+;
+;   - vector 14 (page fault) and vector 32 (IRQ0, the timer), and
+;   - vectors 48 and 49, which are only used to benchmark the two entry
+;     paths against each other (see 'BenchmarkIRQRoundTrip()' in kernel.C),
+;   - vectors 64 and 65, the local APIC timer and the TLB shootdown IPI
+;     (see 'smp.H'). These come from the local APIC, not from the PICs,
+;     so they have no IRQ number and no entry in the handler tables.
+;
+; A hot stub differs from the generic one in three ways:
+;  1. It saves and reloads the segment registers only if the interrupted
+;     context ran in user mode. In kernel mode they already hold the kernel
+;     selectors, so we merely reserve their slots to keep the REGS layout.
+;  2. It calls its handler through 'hot_vector_table[]' (see 'interrupts.C')
+;     with a constant index, i.e. with a single memory-indirect call and
+;     without going through 'lowlevel_dispatch_*' and the handler tables.
+;  3. The C side has no range checks or diagnostic output.
+;
+; The table indices must match enum 'HotVector' in 'interrupts.H'.
+;
+; The stubs go into the hot text group (see 'sections.H'); the section is
+; switched back at the end of the file, which is included in 'start.asm'.
+
+extern _hot_vector_table
+
+SECTION .text.hot progbits alloc exec nowrite align=16
+
+; HOT_ENTRY index
+; Expects the error code and the vector number on the stack, builds a REGS
+; frame, calls hot_vector_table[index] with a pointer to it, and returns
+; from the interrupt.
+%macro HOT_ENTRY 1
+    pusha
+    test dword [esp + 44], 3    ; RPL of the interrupted CS (REGS.cs)
+    jnz %%from_user
+
+    sub esp, 16                 ; kernel mode: segment slots stay unused
+    push esp
+    call [_hot_vector_table + 4 * %1]
+    add esp, 20
+    popa
+    add esp, 8
+    iret
+
+%%from_user:
+    push ds
+    push es
+    push fs
+    push gs
+    mov ax, 0x10                ; kernel data segment
+    mov ds, ax
+    mov es, ax
+    mov fs, ax
+    mov ax, 0x20                ; per-CPU data segment (see gdt.H)
+    mov gs, ax
+    push esp
+    call [_hot_vector_table + 4 * %1]
+    add esp, 4
+    pop gs
+    pop fs
+    pop es
+    pop ds
+    popa
+    add esp, 8
+    iret
+%endmacro
+
+global _isr14_fast
+global _irq0_fast
+global _irq_bench_fast
+global _irq_bench_slow
+global _lapic_timer_entry
+global _ipi_tlb_shootdown_entry
+global _lapic_spurious_entry
+
+; 14: Page Fault Exception (With Error Code!)
+_isr14_fast:
+    push byte 14
+    HOT_ENTRY 1                 ; HOT_PAGE_FAULT
+
+; 32: IRQ0 (timer)
+_irq0_fast:
+    push byte 0
+    push byte 32
+    HOT_ENTRY 0                 ; HOT_TIMER
+
+; 48: software-triggered, fast path to the IRQ15 handler
+_irq_bench_fast:
+    push byte 0
+    push byte 47
+    HOT_ENTRY 2                 ; HOT_BENCH
+
+; 49: software-triggered, generic path to the IRQ15 handler
+_irq_bench_slow:
+    push byte 0
+    push byte 47
+    jmp irq_common_stub
+
+; 64: local APIC timer
+_lapic_timer_entry:
+    push byte 0
+    push byte 64
+    HOT_ENTRY 3                 ; HOT_LAPIC_TIMER
+
+; 65: TLB shootdown IPI
+_ipi_tlb_shootdown_entry:
+    push byte 0
+    push byte 65
+    HOT_ENTRY 4                 ; HOT_TLB_SHOOTDOWN
+
+; 255: spurious interrupt from the local APIC; must not be acknowledged
+_lapic_spurious_entry:
+    iret
+
+SECTION .text
@@ -113,6 +113,9 @@ _irq15:
 
 extern _lowlevel_dispatch_interrupt
 
+; Shared by every IRQ without a hot stub, e.g. the virtio devices.
+SECTION .text.hot progbits alloc exec nowrite align=16
+
 irq_common_stub:
     pusha
     push ds
@@ -134,3 +137,5 @@ irq_common_stub:
     popa
     add esp, 8
     iret
+
+SECTION .text
@@ -0,0 +1,48 @@
+; File: kexec_low.asm
+;
+; The last steps of a warm reboot, see 'kexec.H'.
+;
+; 'Kexec::boot()' copies the code between _kexec_trampoline and
+; _kexec_trampoline_end to an identity-mapped frame below 4MB, with
+; interrupts disabled and the other CPUs stopped, and calls the copy with
+; the address of its parameters (struct TrampolineParameters in
+; 'kexec.C'). The trampoline
+;   1. turns paging off, and the paging extensions in CR4,
+;   2. copies the new image to its load address, and clears its BSS,
+;   3. jumps to its entry with the multiboot magic in EAX and the
+;      multiboot information in EBX, as a boot loader would.
+; It has no absolute addresses, and uses no stack after its first
+; instruction: the old kernel's stack may be overwritten by the copy.
+
+global _kexec_trampoline
+global _kexec_trampoline_end
+
+section .text
+
+[BITS 32]
+_kexec_trampoline:
+	mov	esi, [esp+4]		; the parameters
+
+	mov	eax, cr0
+	and	eax, 0x7FFFFFFF		; PG
+	mov	cr0, eax
+	xor	eax, eax
+	mov	cr4, eax		; PAE, PGE
+	mov	cr3, eax		; flush the TLB
+
+	mov	ebx, [esi+20]		; info
+	mov	edx, [esi+16]		; entry
+	mov	eax, [esi+12]		; bss_size
+	mov	ecx, [esi+8]		; load_size
+	mov	edi, [esi+4]		; destination
+	mov	esi, [esi]		; source
+
+	cld
+	rep	movsb
+	mov	ecx, eax
+	xor	eax, eax
+	rep	stosb
+
+	mov	eax, 0x2BADB002		; multiboot loader magic
+	jmp	edx
+_kexec_trampoline_end:
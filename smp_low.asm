@@ -0,0 +1,84 @@
+
+; File: smp_low.asm
+;
+; Startup code for the application processors (APs).
+;
+; An AP starts in real mode, at the 4KB-aligned address given in the
+; Startup IPI. 'SMP::init()' copies the code between
+; _smp_trampoline_start and _smp_trampoline_end to TRAMPOLINE_BASE in low
+; memory, and fills in the four parameters at the end of the copy before
+; it starts an AP. The trampoline then
+;   1. switches to protected mode with a temporary flat GDT,
+;   2. enables paging with the paging mode (CR4) and the page directory
+;      of the boot CPU,
+;   3. loads the stack pointer and calls the C++ entry point.
+; The entry point sets up the GDT of the AP and never returns.
+;
+; The code runs at TRAMPOLINE_BASE, not where it was linked, so every
+; absolute address goes through REL(). Must match 'SMP::TRAMPOLINE_ADDRESS'.
+
+TRAMPOLINE_BASE equ 0x8000
+%define REL(x) (TRAMPOLINE_BASE + ((x) - _smp_trampoline_start))
+
+global _smp_trampoline_start
+global _smp_trampoline_end
+global _smp_trampoline_cr3
+global _smp_trampoline_cr4
+global _smp_trampoline_stack
+global _smp_trampoline_entry
+
+section .text
+
+[BITS 16]
+_smp_trampoline_start:
+	cli
+	cld
+	xor	ax, ax
+	mov	ds, ax
+	lgdt	[REL(tramp_gdt_ptr)]
+	mov	eax, cr0
+	or	eax, 1			; PE
+	mov	cr0, eax
+	jmp	dword 0x08:REL(tramp_protected)
+
+[BITS 32]
+tramp_protected:
+	mov	ax, 0x10
+	mov	ds, ax
+	mov	es, ax
+	mov	fs, ax
+	mov	gs, ax
+	mov	ss, ax
+
+	mov	eax, [REL(_smp_trampoline_cr4)]
+	mov	cr4, eax		; PAE, if the boot CPU uses it
+	mov	eax, [REL(_smp_trampoline_cr3)]
+	mov	cr3, eax
+	mov	eax, cr0
+	or	eax, 0x80010000		; PG, WP (as on the boot CPU)
+	mov	cr0, eax
+
+	mov	esp, [REL(_smp_trampoline_stack)]
+	mov	eax, [REL(_smp_trampoline_entry)]
+	call	eax
+
+.hang:					; the entry point does not return
+	cli
+	hlt
+	jmp	.hang
+
+align 8
+tramp_gdt:
+	dq	0x0000000000000000	; null
+	dq	0x00CF9A000000FFFF	; 0x08: flat code, 4GB
+	dq	0x00CF92000000FFFF	; 0x10: flat data, 4GB
+tramp_gdt_ptr:
+	dw	23
+	dd	REL(tramp_gdt)
+
+align 4
+_smp_trampoline_cr3:	dd 0		; page directory of the boot CPU
+_smp_trampoline_cr4:	dd 0		; paging mode of the boot CPU
+_smp_trampoline_stack:	dd 0		; top of the stack of the AP
+_smp_trampoline_entry:	dd 0		; C++ entry point
+_smp_trampoline_end:
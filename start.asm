@@ -12,6 +12,10 @@
 global start
 start:
     mov esp, _sys_stack     ; This points the stack to our new stack area
+    ; The boot loader passes the multiboot magic in EAX and the address of
+    ; the multiboot information in EBX; keep them for Multiboot::init().
+    mov [_multiboot_magic], eax
+    mov [_multiboot_info], ebx
     jmp stublet
 
 ; This part MUST be 4byte aligned, so we solve that issue using 'ALIGN 4'
@@ -100,6 +104,18 @@ static_dtors_loop:
 ; Set up Low-level Interrupt Handling
 %include "irq_low.asm"
 
+; Dedicated entry stubs for hot vectors
+%include "hot_low.asm"
+
+; Boot loader handoff, see multiboot.H
+SECTION .data
+global _multiboot_magic
+global _multiboot_info
+_multiboot_magic:
+    dd 0
+_multiboot_info:
+    dd 0
+
 ; Here is the definition of our BSS section. Right now, we'll use
 ; it just to store the stack. Remember that a stack actually grows
 ; downwards, so we declare the size of the data before declaring
@@ -0,0 +1,36 @@
+
+; File: threads_low.asm
+;
+; Low-level thread context switch.
+;
+; Only the callee-saved registers (EBX, ESI, EDI, EBP) and EFLAGS need to
+; be saved: the switch is a function call, so the compiler has already
+; saved everything else. Saving EFLAGS carries the interrupt flag along
+; with the thread, i.e. a thread that was switched out from an interrupt
+; handler resumes with interrupts disabled, and vice versa.
+
+; on every thread switch: hot text group, see 'sections.H'
+SECTION .text.hot progbits alloc exec nowrite align=16
+
+; ----------------------------------------------------------------------
+; threads_low_switch_to(char ** _save_esp, char * _new_esp)
+; ----------------------------------------------------------------------
+global _threads_low_switch_to
+_threads_low_switch_to:
+	mov	eax, [esp+4]	; where to save our stack pointer
+	mov	edx, [esp+8]	; stack pointer of the thread to switch to
+
+	pushfd
+	push	ebp
+	push	ebx
+	push	esi
+	push	edi
+	mov	[eax], esp
+
+	mov	esp, edx
+	pop	edi
+	pop	esi
+	pop	ebx
+	pop	ebp
+	popfd
+	ret